@@ -0,0 +1,246 @@
+#include <Arduino.h>
+
+#include "../src/boot.hpp"
+#include "../src/fsm.hpp"
+#include "../src/keypad.hpp"
+#include "../src/relays.hpp"
+#include "../src/ui.hpp"
+
+// Microbenchmarks for the firmware hot paths.
+//
+// On target (bench_uno) every measurement is in CPU cycles from Timer1 at
+// prescaler 1, with the Timer0 (millis) interrupt masked so the numbers are
+// exact and repeatable. On the host (bench_native) the same code runs against
+// the stubs in bench/host and is timed in nanoseconds.
+//
+// Each result is one line: BENCH,<platform>,<name>,<iterations>,<unit>,<total>
+// where <total> covers the whole batch minus a baseline batch that does the
+// same argument preparation without the call. Results are printed only after
+// the counter stops, so no serial ISR runs inside a measurement.
+// bench/compare.py turns the totals into per-call figures and checks them
+// against a baseline. On target a BUDGET,<platform>,<name>,<unit>,<value>,<limit>
+// line also reports the boot CONTROL timestamp, which compare.py fails on
+// when it exceeds Boot::kControlBudgetUs.
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#else
+#include <chrono>
+#endif
+
+namespace {
+
+#if defined(__AVR__)
+using Ticks = uint32_t;
+constexpr const char* kPlatform = "avr";
+constexpr const char* kUnit = "cycles";
+constexpr uint16_t kIterations = 200;
+constexpr uint8_t kRepeats = 1;
+
+volatile uint16_t timer1Overflows = 0;
+uint8_t savedTimsk0 = 0;
+
+void counterBegin() {
+    savedTimsk0 = TIMSK0;
+    TIMSK0 = 0;
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 = _BV(TOIE1);
+    TCCR1B = _BV(CS10);
+}
+
+void counterEnd() {
+    TCCR1B = 0;
+    TIMSK1 = 0;
+    TIMSK0 = savedTimsk0;
+}
+
+Ticks counterNow() {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t count = TCNT1;
+    uint16_t overflows = timer1Overflows;
+    // Account for an overflow that happened after cli() but is not serviced yet.
+    if ((TIFR1 & _BV(TOV1)) && count < 0x8000) {
+        ++overflows;
+    }
+    SREG = sreg;
+    return (static_cast<Ticks>(overflows) << 16) | count;
+}
+#else
+using Ticks = unsigned long;
+constexpr const char* kPlatform = "host";
+constexpr const char* kUnit = "ns";
+constexpr uint16_t kIterations = 50000;
+// Wall-clock timing is noisy; keep the fastest of several batches.
+constexpr uint8_t kRepeats = 9;
+
+void counterBegin() {}
+void counterEnd() {}
+
+Ticks counterNow() {
+    using namespace std::chrono;
+    static const steady_clock::time_point origin = steady_clock::now();
+    return static_cast<Ticks>(duration_cast<nanoseconds>(steady_clock::now() - origin).count());
+}
+#endif
+
+struct Result {
+    const char* name;
+    Ticks net;
+};
+
+constexpr uint8_t kMaxResults = 8;
+
+Relays relays;
+volatile uint8_t sink = 0;
+Result results[kMaxResults];
+uint8_t resultCount = 0;
+
+template <typename Fn>
+Ticks measure(Fn fn) {
+    // Drain pending serial output so the UDRE interrupt stays out of the batch.
+    Serial.flush();
+    Ticks best = 0;
+    for (uint8_t r = 0; r < kRepeats; ++r) {
+        Ticks start = counterNow();
+        for (uint16_t i = 0; i < kIterations; ++i) {
+            fn(i);
+        }
+        Ticks elapsed = counterNow() - start;
+        if (r == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+// Times `fn` and subtracts `base`, which must do the same per-iteration
+// bookkeeping (indexing, modulo, sink store) without the function under test.
+template <typename Fn, typename Base>
+void bench(const char* name, Fn fn, Base base) {
+    Ticks total = measure(fn);
+    Ticks overhead = measure(base);
+    if (resultCount < kMaxResults) {
+        results[resultCount].name = name;
+        results[resultCount].net = total > overhead ? total - overhead : 0;
+        ++resultCount;
+    }
+}
+
+void emit(const Result& result) {
+    Serial.print(F("BENCH,"));
+    Serial.print(kPlatform);
+    Serial.print(',');
+    Serial.print(result.name);
+    Serial.print(',');
+    Serial.print(static_cast<unsigned long>(kIterations));
+    Serial.print(',');
+    Serial.print(kUnit);
+    Serial.print(',');
+    Serial.println(static_cast<unsigned long>(result.net));
+}
+
+// One ADC sample per key band plus the idle reading.
+const int kAdcSamples[] = {0, 100, 250, 450, 700, 1023};
+constexpr uint8_t kAdcSampleCount = sizeof(kAdcSamples) / sizeof(kAdcSamples[0]);
+
+void runBenchmarks() {
+    // Finish the real boot pipeline first, so its stage report lands in the output too.
+    while (!Boot::done()) {
+        Boot::update();
+    }
+
+    auto empty = [](uint16_t) {};
+    counterBegin();
+
+    // Reset-to-control path: relays safe, FSM and flow metering started.
+    bench("Boot::begin", [](uint16_t) { Boot::begin(&relays); }, empty);
+
+    // Steady SERVICE state with a frozen clock: every call takes the same path.
+    Fsm::start();
+
+    bench("mapAnalogToKey",
+          [](uint16_t i) { sink = Keypad::mapAnalogToKey(kAdcSamples[i % kAdcSampleCount], Keypad::Key::NONE); },
+          [](uint16_t i) { sink = static_cast<uint8_t>(kAdcSamples[i % kAdcSampleCount]); });
+
+    bench("Keypad::readKey", [](uint16_t) { sink = Keypad::readKey(); }, [](uint16_t) { sink = 0; });
+
+    bench("Fsm::update", [](uint16_t) { Fsm::update(); }, empty);
+
+    bench("Fsm::getRemaining",
+          [](uint16_t) {
+              uint16_t minutes = 0;
+              uint16_t seconds = 0;
+              Fsm::getRemaining(minutes, seconds);
+              sink = static_cast<uint8_t>(minutes + seconds);
+          },
+          [](uint16_t) { sink = 0; });
+
+    // Line formatting alone: what a UI optimization changes.
+    bench("uiFormat",
+          [](uint16_t i) {
+              char line1[kUiLineSize];
+              char line2[kUiLineSize];
+              uint16_t value = static_cast<uint16_t>(i % 60);
+              uiFormat(line1, line2, value, value);
+              sink = static_cast<uint8_t>(line1[0] + line2[0]);
+          },
+          [](uint16_t i) { sink = static_cast<uint8_t>(i % 60); });
+
+    // Formatting plus the LCD write; on bench_uno this is dominated by the
+    // HD44780 driver's delayMicroseconds() per nibble.
+    bench("uiRender+lcd",
+          [](uint16_t i) {
+              uint16_t value = static_cast<uint16_t>(i % 60);
+              uiRender(value, value);
+          },
+          [](uint16_t i) { sink = static_cast<uint8_t>(i % 60); });
+
+    counterEnd();
+
+    for (uint8_t i = 0; i < resultCount; ++i) {
+        emit(results[i]);
+    }
+#if defined(__AVR__)
+    // The host clock is simulated, so only the target timestamp means anything.
+    Serial.print(F("BUDGET,"));
+    Serial.print(kPlatform);
+    Serial.print(F(",Boot::control,us,"));
+    Serial.print(static_cast<unsigned long>(Boot::timestampUs(Boot::Stage::CONTROL)));
+    Serial.print(',');
+    Serial.println(static_cast<unsigned long>(Boot::kControlBudgetUs));
+#endif
+    Serial.println(F("BENCH,done"));
+}
+
+}  // namespace
+
+#if defined(__AVR__)
+ISR(TIMER1_OVF_vect) {
+    ++timer1Overflows;
+}
+#endif
+
+void setup() {
+#if !defined(__AVR__)
+    Host::setMillis(1);
+    Host::setAnalog(Board::kKeypadPin, 1023);
+#endif
+    // Same order as main.cpp, so the CONTROL timestamp matches the firmware's.
+    Boot::begin(&relays);
+    Serial.begin(115200);
+    Boot::mark(Boot::Stage::SERIAL_UP);
+    runBenchmarks();
+}
+
+void loop() {}
+
+#if !defined(ARDUINO)
+int main() {
+    setup();
+    return 0;
+}
+#endif
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Compare benchmark output against a stored baseline.
+
+Reads the BENCH lines printed by bench_main.cpp (serial capture or host
+stdout), prints per-call figures next to the baseline and exits non-zero
+when any benchmark regresses by more than --threshold percent, or when a
+BUDGET line (the on-target boot CONTROL timestamp) exceeds its limit.
+
+    pio run -e bench_native && .pio/build/bench_native/program > host.txt
+    python3 bench/compare.py host.txt bench/baseline-host.csv --threshold 25
+
+    pio device monitor -e bench_uno > avr.txt
+    python3 bench/compare.py avr.txt bench/baseline-avr.csv
+
+No baseline ships with the repo: the first run must use --update to
+create bench/baseline-avr.csv or bench/baseline-host.csv.
+"""
+
+import argparse
+import os
+import sys
+
+
+def parse(path):
+    results = {}
+    with open(path, encoding="utf-8", errors="replace") as handle:
+        for line in handle:
+            fields = line.strip().split(",")
+            if len(fields) != 6 or fields[0] != "BENCH":
+                continue
+            _, platform, name, iterations, unit, total = fields
+            results[(platform, name)] = (int(iterations), unit, int(total))
+    return results
+
+
+def parse_budgets(path):
+    budgets = []
+    with open(path, encoding="utf-8", errors="replace") as handle:
+        for line in handle:
+            fields = line.strip().split(",")
+            if len(fields) != 6 or fields[0] != "BUDGET":
+                continue
+            _, platform, name, unit, value, limit = fields
+            budgets.append((f"{platform}:{name}", unit, int(value), int(limit)))
+    return budgets
+
+
+def per_call(entry):
+    iterations, _, total = entry
+    return total / iterations if iterations else 0.0
+
+
+def write_baseline(path, results):
+    with open(path, "w", encoding="utf-8") as handle:
+        for (platform, name), (iterations, unit, total) in sorted(results.items()):
+            handle.write(f"BENCH,{platform},{name},{iterations},{unit},{total}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("results", help="captured benchmark output")
+    parser.add_argument("baseline", help="baseline file in the same BENCH format")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="allowed per-call regression in percent (default 5)")
+    parser.add_argument("--update", action="store_true",
+                        help="write the results as the new baseline")
+    args = parser.parse_args()
+
+    current = parse(args.results)
+    if not current:
+        print(f"no BENCH lines in {args.results}", file=sys.stderr)
+        return 2
+
+    over = 0
+    for label, unit, value, limit in parse_budgets(args.results):
+        within = value <= limit
+        over += 0 if within else 1
+        print(f"{label:<28}{value:>12}{limit:>12}  {unit}  {'within budget' if within else 'OVER BUDGET'}")
+    if over:
+        return 1
+
+    if args.update:
+        write_baseline(args.baseline, current)
+        print(f"baseline written to {args.baseline} ({len(current)} entries)")
+        return 0
+
+    if not os.path.exists(args.baseline):
+        print(f"baseline {args.baseline} not found; create it with --update", file=sys.stderr)
+        return 2
+    baseline = parse(args.baseline)
+
+    regressions = 0
+    print(f"{'benchmark':<28}{'baseline':>12}{'current':>12}{'delta':>9}  unit")
+    for key in sorted(current):
+        platform, name = key
+        now = per_call(current[key])
+        unit = current[key][1]
+        label = f"{platform}:{name}"
+        if key not in baseline:
+            print(f"{label:<28}{'-':>12}{now:>12.1f}{'new':>9}  {unit}")
+            continue
+        before = per_call(baseline[key])
+        delta = (now - before) / before * 100.0 if before else 0.0
+        flag = ""
+        if delta > args.threshold:
+            regressions += 1
+            flag = "  REGRESSION"
+        print(f"{label:<28}{before:>12.1f}{now:>12.1f}{delta:>+8.1f}%  {unit}{flag}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,63 @@
+#pragma once
+
+// Minimal Arduino API for running the firmware sources on the host
+// (bench_native environment). Only what src/ actually uses is provided.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+
+    void print(const char* text);
+    void print(const __FlashStringHelper* text);
+    void print(char value);
+    void print(int value);
+    void print(unsigned int value);
+    void print(long value);
+    void print(unsigned long value);
+
+    void println();
+    void flush();
+    template <typename T>
+    void println(T value) {
+        print(value);
+        println();
+    }
+};
+
+extern HardwareSerial Serial;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+unsigned long millis();
+unsigned long micros();
+
+void noInterrupts();
+void interrupts();
+
+// Host-only controls for the simulated clock, ADC and EEPROM.
+namespace Host {
+void setMillis(unsigned long ms);
+void advanceMillis(unsigned long ms);
+void setMicros(unsigned long us);
+void advanceMicros(unsigned long us);
+void setAnalog(uint8_t pin, int value);
+void eraseEeprom();
+}  // namespace Host
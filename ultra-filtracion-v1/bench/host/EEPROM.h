@@ -0,0 +1,15 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Host stand-in for the AVR EEPROM library: 1 KiB that starts erased (0xFF)
+// and survives Fsm::begin()/Boot::begin(), like the real part across a reset.
+class EEPROMClass {
+public:
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value);
+    uint16_t length();
+};
+
+extern EEPROMClass EEPROM;
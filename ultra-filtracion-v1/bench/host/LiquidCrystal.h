@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Host stand-in for the HD44780 driver: keeps a 16x2 frame buffer so the
+// formatting work in uiRender is exercised without any bus timing.
+class LiquidCrystal {
+public:
+    LiquidCrystal(uint8_t rs, uint8_t enable, uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7);
+
+    void begin(uint8_t cols, uint8_t rows);
+    void clear();
+    void setCursor(uint8_t col, uint8_t row);
+    void print(const char* text);
+    void print(char value);
+
+    char frame[2][17];
+
+    // Lets host tests check when the display was initialised.
+    static unsigned beginCalls;
+
+private:
+    uint8_t col_ = 0;
+    uint8_t row_ = 0;
+};
@@ -0,0 +1,169 @@
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <LiquidCrystal.h>
+
+namespace {
+unsigned long fakeMicros = 0;
+unsigned long fakeMillis = 0;
+int analogValues[128] = {0};
+constexpr int kEepromSize = 1024;
+uint8_t eepromCells[kEepromSize];
+bool eepromReady = false;
+
+uint8_t& eepromCell(int address) {
+    if (!eepromReady) {
+        memset(eepromCells, 0xFF, sizeof(eepromCells));
+        eepromReady = true;
+    }
+    return eepromCells[address & (kEepromSize - 1)];
+}
+}
+
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long) {}
+
+void HardwareSerial::print(const char* text) {
+    fputs(text, stdout);
+}
+
+void HardwareSerial::print(const __FlashStringHelper* text) {
+    print(reinterpret_cast<const char*>(text));
+}
+
+void HardwareSerial::print(char value) {
+    fputc(value, stdout);
+}
+
+void HardwareSerial::print(int value) {
+    printf("%d", value);
+}
+
+void HardwareSerial::print(unsigned int value) {
+    printf("%u", value);
+}
+
+void HardwareSerial::print(long value) {
+    printf("%ld", value);
+}
+
+void HardwareSerial::print(unsigned long value) {
+    printf("%lu", value);
+}
+
+void HardwareSerial::println() {
+    fputc('\n', stdout);
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+
+int digitalRead(uint8_t) {
+    return HIGH;
+}
+
+int analogRead(uint8_t pin) {
+    return analogValues[pin & 0x7F];
+}
+
+unsigned long millis() {
+    return fakeMillis;
+}
+
+// Simulated clock starting at 0 with the process, like the AVR timer after
+// init(). Each read ticks it by 1 us so consecutive reads stay ordered; tests
+// move it further with Host::advanceMicros().
+unsigned long micros() {
+    return ++fakeMicros;
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+namespace Host {
+
+void setMillis(unsigned long ms) {
+    fakeMillis = ms;
+}
+
+void advanceMillis(unsigned long ms) {
+    fakeMillis += ms;
+}
+
+void setMicros(unsigned long us) {
+    fakeMicros = us;
+}
+
+void advanceMicros(unsigned long us) {
+    fakeMicros += us;
+}
+
+void setAnalog(uint8_t pin, int value) {
+    analogValues[pin & 0x7F] = value;
+}
+
+void eraseEeprom() {
+    memset(eepromCells, 0xFF, sizeof(eepromCells));
+    eepromReady = true;
+}
+
+}  // namespace Host
+
+EEPROMClass EEPROM;
+
+uint8_t EEPROMClass::read(int address) {
+    return eepromCell(address);
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    eepromCell(address) = value;
+}
+
+void EEPROMClass::update(int address, uint8_t value) {
+    if (eepromCell(address) != value) {
+        eepromCell(address) = value;
+    }
+}
+
+uint16_t EEPROMClass::length() {
+    return kEepromSize;
+}
+
+LiquidCrystal::LiquidCrystal(uint8_t, uint8_t, uint8_t, uint8_t, uint8_t, uint8_t) {
+    clear();
+}
+
+unsigned LiquidCrystal::beginCalls = 0;
+
+void LiquidCrystal::begin(uint8_t, uint8_t) {
+    ++beginCalls;
+}
+
+void LiquidCrystal::clear() {
+    memset(frame, ' ', sizeof(frame));
+    frame[0][16] = '\0';
+    frame[1][16] = '\0';
+    col_ = 0;
+    row_ = 0;
+}
+
+void LiquidCrystal::setCursor(uint8_t col, uint8_t row) {
+    col_ = col;
+    row_ = row & 1;
+}
+
+void LiquidCrystal::print(const char* text) {
+    while (*text) {
+        print(*text++);
+    }
+}
+
+void LiquidCrystal::print(char value) {
+    if (col_ < 16) {
+        frame[row_][col_++] = value;
+    }
+}
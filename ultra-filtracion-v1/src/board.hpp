@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Compile-time hardware profiles. Every driver reads its pins, polarity and
+// thresholds from `Board`, so switching targets costs no RAM and no runtime
+// indirection. The arrays are only indexed with constants (drivers expand
+// them with templates), so they are never odr-used and stay out of SRAM.
+// Analog pins are written as `kAnalogBase + n` because the A8..A15 macros
+// only exist on the Mega core.
+
+namespace Boards {
+
+struct Uno {
+    static constexpr uint8_t kAnalogBase = 14;
+
+    // PERM, WASH_A, WASH_B, FREE.
+    static constexpr uint8_t kRelayCount = 4;
+    static constexpr uint8_t kRelayPins[kRelayCount] = {2, 3, 11, 12};
+    // Same relays as raw port/bit, for the .init3 hook that runs before the
+    // Arduino core is usable. Must match kRelayPins.
+    static constexpr char kRelayPorts[kRelayCount] = {'D', 'D', 'B', 'B'};
+    static constexpr uint8_t kRelayBits[kRelayCount] = {2, 3, 3, 4};
+    static constexpr bool kRelayActiveLow = true;
+
+    // Upper ADC bounds for RIGHT, UP, DOWN, LEFT, SELECT.
+    static constexpr uint8_t kKeypadPin = kAnalogBase + 0;
+    static constexpr int kKeyThresholds[5] = {50, 150, 350, 550, 800};
+
+    static constexpr uint8_t kLcdRs = 8;
+    static constexpr uint8_t kLcdEnable = 9;
+    static constexpr uint8_t kLcdD4 = 4;
+    static constexpr uint8_t kLcdD5 = 5;
+    static constexpr uint8_t kLcdD6 = 6;
+    static constexpr uint8_t kLcdD7 = 7;
+
+    // Permeate and flush meters, both on PCINT1 (port C).
+    static constexpr uint8_t kFlowPins[2] = {kAnalogBase + 1, kAnalogBase + 2};
+};
+
+struct Mega2560 {
+    static constexpr uint8_t kAnalogBase = 54;
+
+    // Same shield-compatible core relays as the Uno plus four auxiliary
+    // relays on the double header for additional trains.
+    static constexpr uint8_t kRelayCount = 8;
+    static constexpr uint8_t kRelayPins[kRelayCount] = {2, 3, 11, 12, 22, 23, 24, 25};
+    static constexpr char kRelayPorts[kRelayCount] = {'E', 'E', 'B', 'B', 'A', 'A', 'A', 'A'};
+    static constexpr uint8_t kRelayBits[kRelayCount] = {4, 5, 5, 6, 0, 1, 2, 3};
+    static constexpr bool kRelayActiveLow = true;
+
+    static constexpr uint8_t kKeypadPin = kAnalogBase + 0;
+    static constexpr int kKeyThresholds[5] = {50, 150, 350, 550, 800};
+
+    static constexpr uint8_t kLcdRs = 8;
+    static constexpr uint8_t kLcdEnable = 9;
+    static constexpr uint8_t kLcdD4 = 4;
+    static constexpr uint8_t kLcdD5 = 5;
+    static constexpr uint8_t kLcdD6 = 6;
+    static constexpr uint8_t kLcdD7 = 7;
+
+    // A1..A7 have no pin-change interrupt on the 2560; A8/A9 sit on PCINT2 (port K).
+    static constexpr uint8_t kFlowPins[2] = {kAnalogBase + 8, kAnalogBase + 9};
+};
+
+}  // namespace Boards
+
+// ISR vector names are macros, so the flow meter vector is selected here too.
+#if defined(ARDUINO_AVR_MEGA2560)
+using Board = Boards::Mega2560;
+#define BOARD_FLOW_PCINT_vect PCINT2_vect
+#else
+using Board = Boards::Uno;
+#define BOARD_FLOW_PCINT_vect PCINT1_vect
+#endif
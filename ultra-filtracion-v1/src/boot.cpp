@@ -0,0 +1,93 @@
+#include <Arduino.h>
+#include "boot.hpp"
+
+#include "flow.hpp"
+#include "fsm.hpp"
+#include "relays.hpp"
+#include "ui.hpp"
+
+namespace {
+uint32_t stageUs[Boot::kStageCount] = {0};
+Boot::Stage pendingStage = Boot::Stage::LCD;
+bool finished = false;
+
+const char* const stageNames[] = {"safe", "control", "serial", "lcd", "ready"};
+
+void report() {
+    Serial.print(F("[Boot] since init():"));
+    for (uint8_t i = 0; i < Boot::kStageCount; ++i) {
+        Serial.print(' ');
+        Serial.print(stageNames[i]);
+        Serial.print('=');
+        Serial.print(static_cast<unsigned long>(stageUs[i]));
+        Serial.print(F("us"));
+    }
+    Serial.println();
+
+    uint32_t control = stageUs[static_cast<uint8_t>(Boot::Stage::CONTROL)];
+    Serial.print(F("[Boot] control "));
+    Serial.print(static_cast<unsigned long>(control));
+    Serial.print(F("/"));
+    Serial.print(static_cast<unsigned long>(Boot::kControlBudgetUs));
+    Serial.println(control <= Boot::kControlBudgetUs ? F("us since init() within budget")
+                                                     : F("us since init() OVER BUDGET"));
+}
+
+}  // namespace
+
+namespace Boot {
+
+void begin(Relays* relays) {
+    // Pins were already parked at their safe level from .init3 (see relays.cpp);
+    // this re-asserts them with the driver before anything else runs.
+    relays->begin();
+    mark(Stage::SAFE);
+
+    Fsm::begin(relays);
+    Fsm::restoreCeb();
+    Fsm::enableStartupFlush(false);
+    Flow::begin();
+    mark(Stage::CONTROL);
+
+    pendingStage = Stage::LCD;
+    finished = false;
+}
+
+void update() {
+    if (finished) {
+        return;
+    }
+    switch (pendingStage) {
+        case Stage::LCD:
+            // Blocks for the HD44780 power-on delays, but control is already running.
+            uiBegin();
+            mark(Stage::LCD);
+            pendingStage = Stage::READY;
+            break;
+        case Stage::READY:
+            Serial.println(F("[System] Ready"));
+            mark(Stage::READY);
+            report();
+            finished = true;
+            break;
+        case Stage::SAFE:
+        case Stage::CONTROL:
+        case Stage::SERIAL_UP:
+        default:
+            break;
+    }
+}
+
+void mark(Stage stage) {
+    stageUs[static_cast<uint8_t>(stage)] = micros();
+}
+
+uint32_t timestampUs(Stage stage) {
+    return stageUs[static_cast<uint8_t>(stage)];
+}
+
+bool done() {
+    return finished;
+}
+
+}  // namespace Boot
@@ -0,0 +1,240 @@
+#include <Arduino.h>
+#include "flow.hpp"
+
+#include "board.hpp"
+
+#ifndef FLOW_PULSES_PER_LITER
+#define FLOW_PULSES_PER_LITER 450
+#endif
+
+namespace {
+// D2/D3 (INT0/INT1) are taken by R_PERM and R_WA, so both meters share
+// one pin-change vector chosen by the board profile.
+static_assert(sizeof(Board::kFlowPins) == Flow::kMeterCount, "one flow pin per meter");
+constexpr uint32_t kPulsesPerLiter = FLOW_PULSES_PER_LITER;
+constexpr uint32_t kMlPerLiter = 1000UL;
+constexpr uint32_t kMicrosPerMinute = 60000000UL;
+constexpr uint32_t kGlitchUs = 500UL;
+constexpr uint32_t kRateTimeoutUs = 2000000UL;
+
+struct Channel {
+    volatile uint32_t pulses;
+    volatile uint32_t lastPulseUs;
+    volatile uint32_t periodUs;
+    volatile bool primed;
+};
+
+Channel channels[Flow::kMeterCount];
+uint32_t foldedPulses[Flow::kMeterCount] = {0};
+uint32_t pulseRemainder[Flow::kMeterCount] = {0};
+Flow::Totals totals = {Flow::kTotalsVersion, Flow::kMeterCount, Fsm::kStateCount, {}};
+
+#if defined(__AVR__)
+volatile uint8_t* inputRegs[Flow::kMeterCount];
+uint8_t inputMasks[Flow::kMeterCount];
+uint8_t lastLevels = 0;
+#endif
+
+#if defined(__AVR__) || FLOW_SIMULATE
+// Called with interrupts disabled (from the ISR or the simulator).
+void countPulse(uint8_t index, uint32_t nowUs) {
+    Channel& channel = channels[index];
+    if (channel.primed) {
+        uint32_t period = nowUs - channel.lastPulseUs;
+        if (period < kGlitchUs) {
+            return;
+        }
+        channel.periodUs = period;
+    }
+    channel.primed = true;
+    channel.lastPulseUs = nowUs;
+    channel.pulses = channel.pulses + 1;
+}
+#endif
+
+uint32_t saturatingAdd(uint32_t a, uint32_t b) {
+    uint32_t sum = a + b;
+    return sum < a ? UINT32_MAX : sum;
+}
+
+uint32_t pulsesToMl(uint8_t index, uint32_t pulses) {
+    uint32_t wholeLiters = pulses / kPulsesPerLiter;
+    uint32_t scaled = (pulses % kPulsesPerLiter) * kMlPerLiter + pulseRemainder[index];
+    pulseRemainder[index] = scaled % kPulsesPerLiter;
+    return wholeLiters * kMlPerLiter + scaled / kPulsesPerLiter;
+}
+
+#if defined(__AVR__)
+uint8_t sampleLevels() {
+    uint8_t levels = 0;
+    for (uint8_t i = 0; i < Flow::kMeterCount; ++i) {
+        if (*inputRegs[i] & inputMasks[i]) {
+            levels |= static_cast<uint8_t>(1U << i);
+        }
+    }
+    return levels;
+}
+#endif
+
+template <uint8_t N>
+struct MeterPins {
+    static constexpr uint8_t kIndex = N - 1;
+    static constexpr uint8_t kPin = Board::kFlowPins[N - 1];
+
+    static void attach() {
+        MeterPins<N - 1>::attach();
+        pinMode(kPin, INPUT_PULLUP);
+#if defined(__AVR__)
+        inputRegs[kIndex] = portInputRegister(digitalPinToPort(kPin));
+        inputMasks[kIndex] = digitalPinToBitMask(kPin);
+        *digitalPinToPCMSK(kPin) |= bit(digitalPinToPCMSKbit(kPin));
+        PCICR |= bit(digitalPinToPCICRbit(kPin));
+#endif
+    }
+};
+
+template <>
+struct MeterPins<0> {
+    static void attach() {}
+};
+
+}  // namespace
+
+#if defined(__AVR__)
+ISR(BOARD_FLOW_PCINT_vect) {
+    uint32_t now = micros();
+    uint8_t levels = sampleLevels();
+    uint8_t rising = levels & static_cast<uint8_t>(~lastLevels);
+    lastLevels = levels;
+    for (uint8_t i = 0; i < Flow::kMeterCount; ++i) {
+        if (rising & (1U << i)) {
+            countPulse(i, now);
+        }
+    }
+}
+#endif
+
+namespace Flow {
+
+void begin() {
+    noInterrupts();
+    for (uint8_t i = 0; i < kMeterCount; ++i) {
+        channels[i].pulses = 0;
+        channels[i].lastPulseUs = 0;
+        channels[i].periodUs = 0;
+        channels[i].primed = false;
+        foldedPulses[i] = 0;
+        pulseRemainder[i] = 0;
+    }
+    MeterPins<kMeterCount>::attach();
+#if defined(__AVR__)
+    lastLevels = sampleLevels();
+#endif
+    interrupts();
+}
+
+void update() {
+    uint8_t phase = static_cast<uint8_t>(Fsm::state());
+    for (uint8_t i = 0; i < kMeterCount; ++i) {
+        noInterrupts();
+        uint32_t pulses = channels[i].pulses;
+        interrupts();
+
+        // Unsigned difference stays correct across counter wrap-around.
+        uint32_t delta = pulses - foldedPulses[i];
+        if (delta == 0) {
+            continue;
+        }
+        foldedPulses[i] = pulses;
+        totals.volumeMl[i][phase] = saturatingAdd(totals.volumeMl[i][phase], pulsesToMl(i, delta));
+    }
+}
+
+uint32_t totalMl(Meter meter) {
+    uint8_t index = static_cast<uint8_t>(meter);
+    uint32_t sum = 0;
+    for (uint8_t s = 0; s < Fsm::kStateCount; ++s) {
+        sum = saturatingAdd(sum, totals.volumeMl[index][s]);
+    }
+    return sum;
+}
+
+uint32_t phaseMl(Meter meter, Fsm::State state) {
+    return totals.volumeMl[static_cast<uint8_t>(meter)][static_cast<uint8_t>(state)];
+}
+
+uint32_t rateMlPerMin(Meter meter) {
+    const Channel& channel = channels[static_cast<uint8_t>(meter)];
+    noInterrupts();
+    bool primed = channel.primed;
+    uint32_t lastPulseUs = channel.lastPulseUs;
+    uint32_t periodUs = channel.periodUs;
+    interrupts();
+
+    if (!primed || periodUs == 0) {
+        return 0;
+    }
+    uint32_t sinceLast = micros() - lastPulseUs;
+    if (sinceLast >= kRateTimeoutUs) {
+        return 0;
+    }
+    // A gap longer than the last period means the flow is slowing down;
+    // report the lower bound instead of a stale rate.
+    if (sinceLast > periodUs) {
+        periodUs = sinceLast;
+    }
+    uint32_t pulsesPerMinute = kMicrosPerMinute / periodUs;
+    return pulsesPerMinute * kMlPerLiter / kPulsesPerLiter;
+}
+
+void snapshot(Totals& out) {
+    out = totals;
+}
+
+bool restore(const Totals& in) {
+    if (in.version != kTotalsVersion || in.meters != kMeterCount || in.states != Fsm::kStateCount) {
+        return false;
+    }
+    totals = in;
+    return true;
+}
+
+void reset() {
+    totals = Totals{kTotalsVersion, kMeterCount, Fsm::kStateCount, {}};
+}
+
+#if FLOW_SIMULATE
+void simulatePulses(Meter meter, uint16_t count, uint32_t periodUs) {
+    if (count == 0) {
+        return;
+    }
+    uint8_t index = static_cast<uint8_t>(meter);
+    const Channel& channel = channels[index];
+    noInterrupts();
+    uint32_t now = micros();
+    uint32_t t = now - static_cast<uint32_t>(count - 1) * periodUs;
+    // Never back-date before the previous pulse, or the period wraps.
+    if (channel.primed) {
+        uint32_t earliest = channel.lastPulseUs + periodUs;
+        if (static_cast<int32_t>(t - earliest) < 0) {
+            t = earliest;
+        }
+    }
+    for (uint16_t n = 0; n < count; ++n) {
+        // Like the ISR, never stamp a pulse after the clock read.
+        countPulse(index, static_cast<int32_t>(t - now) > 0 ? now : t);
+        t += periodUs;
+    }
+    interrupts();
+}
+
+void simulateCounterAt(Meter meter, uint32_t pulses) {
+    uint8_t index = static_cast<uint8_t>(meter);
+    noInterrupts();
+    channels[index].pulses = pulses;
+    foldedPulses[index] = pulses;
+    interrupts();
+}
+#endif
+
+}  // namespace Flow
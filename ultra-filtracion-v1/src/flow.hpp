@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "fsm.hpp"
+
+#ifndef FLOW_SIMULATE
+#define FLOW_SIMULATE 0
+#endif
+
+namespace Flow {
+
+enum class Meter : uint8_t {
+    PERMEATE = 0,
+    FLUSH
+};
+
+constexpr uint8_t kMeterCount = static_cast<uint8_t>(Meter::FLUSH) + 1;
+
+// Bump when the meaning of a stored state index changes without changing
+// Fsm::kStateCount (e.g. states reordered).
+constexpr uint8_t kTotalsVersion = 1;
+
+// Per-meter, per-FSM-state volumes in millilitres. Plain data so it can be
+// written to and restored from non-volatile storage; the header lets
+// restore() reject a blob saved with a different layout.
+struct Totals {
+    uint8_t version;
+    uint8_t meters;
+    uint8_t states;
+    uint32_t volumeMl[kMeterCount][Fsm::kStateCount];
+};
+
+void begin();
+void update();
+
+uint32_t totalMl(Meter meter);
+uint32_t phaseMl(Meter meter, Fsm::State state);
+uint32_t rateMlPerMin(Meter meter);
+
+void snapshot(Totals& totals);
+// Returns false and keeps the current totals if the layout does not match.
+bool restore(const Totals& totals);
+void reset();
+
+#if FLOW_SIMULATE
+// Injects `count` pulses `periodUs` apart, the last one at micros(). Pulses
+// are never stamped in the future: let at least count * periodUs elapse since
+// the previous burst, or the ones that do not fit are dropped as glitches.
+void simulatePulses(Meter meter, uint16_t count, uint32_t periodUs);
+// Presets the raw pulse counter, e.g. just below wrap-around.
+void simulateCounterAt(Meter meter, uint32_t pulses);
+#endif
+
+}  // namespace Flow
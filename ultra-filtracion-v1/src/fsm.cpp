@@ -1,11 +1,21 @@
 #include <Arduino.h>
 #include "fsm.hpp"
 
+#include <EEPROM.h>
+
 #include "relays.hpp"
 #include "ui.hpp"
 
-#ifndef ACTIVE_LOW
-#define ACTIVE_LOW 1
+#ifndef CEB_INTERVAL_CYCLES
+#define CEB_INTERVAL_CYCLES 24
+#endif
+
+#ifndef CEB_DOSE_SECONDS
+#define CEB_DOSE_SECONDS 30
+#endif
+
+#ifndef CEB_SOAK_MINUTES
+#define CEB_SOAK_MINUTES 10
 #endif
 
 namespace {
@@ -15,6 +25,23 @@ constexpr uint32_t kSettleMs = 2000UL;
 constexpr uint32_t kStartupFlushTotalMs = 30000UL;
 constexpr uint32_t kStartupFlushStepMs = 5000UL;
 
+static_assert(CEB_INTERVAL_CYCLES >= 0 && CEB_INTERVAL_CYCLES <= 99, "CEB_INTERVAL_CYCLES out of range 0-99");
+static_assert(CEB_DOSE_SECONDS >= 5 && CEB_DOSE_SECONDS <= 300, "CEB_DOSE_SECONDS out of range 5-300");
+static_assert(CEB_SOAK_MINUTES >= 1 && CEB_SOAK_MINUTES <= 60, "CEB_SOAK_MINUTES out of range 1-60");
+
+// EEPROM bytes holding the CEB bookkeeping across resets. A missing marker
+// (blank or foreign EEPROM) reads as "no CEB history".
+constexpr int kEepromCebMarker = 0;
+constexpr int kEepromCebRinse = 1;
+constexpr int kEepromCebCycles = 2;
+constexpr uint8_t kCebMarker = 0xCE;
+
+enum class CebStep : uint8_t {
+    SETTLE = 0,
+    DOSE,
+    SOAK
+};
+
 Relays* relaysPtr = nullptr;
 Fsm::State currentState = Fsm::State::INIT;
 uint32_t stateStartMs = 0;
@@ -29,13 +56,21 @@ bool startupFlushEnabled = false;
 bool startupFlushDone = false;
 bool startupMode = false;
 uint32_t startupRemainingMs = 0;
+CebStep cebStep = CebStep::SETTLE;
+// Both saved to EEPROM whenever they change; begin() clears the RAM copies
+// and restoreCeb() reloads them.
+uint8_t serviceCyclesSinceCeb = 0;
+bool cebRinsePending = false;
 
 struct Settings {
     uint16_t serviceMinutes = 60;
     uint16_t flushSeconds = 60;
+    uint8_t cebEveryCycles = CEB_INTERVAL_CYCLES;
+    uint16_t cebDoseSeconds = CEB_DOSE_SECONDS;
+    uint16_t cebSoakMinutes = CEB_SOAK_MINUTES;
 } settings;
 
-const char* stateCodes[] = {"INIT", "SERV", "FL_A", "FL_B", "PAUS"};
+const char* stateCodes[] = {"INIT", "SERV", "FL_A", "FL_B", "PAUS", "CEB"};
 
 uint32_t clampServiceMinutes(uint16_t minutes) {
     uint16_t value = minutes;
@@ -51,6 +86,32 @@ uint32_t clampFlushSeconds(uint16_t seconds) {
     return static_cast<uint32_t>(value);
 }
 
+uint8_t clampCebInterval(uint8_t cycles) {
+    return cycles > 99 ? 99 : cycles;
+}
+
+uint16_t clampCebDoseSeconds(uint16_t seconds) {
+    uint16_t value = seconds;
+    if (value < 5) value = 5;
+    if (value > 300) value = 300;
+    return value;
+}
+
+uint16_t clampCebSoakMinutes(uint16_t minutes) {
+    uint16_t value = minutes;
+    if (value < 1) value = 1;
+    if (value > 60) value = 60;
+    return value;
+}
+
+// EEPROM.update() skips unchanged bytes, so this costs one write per service
+// cycle at most.
+void saveCebState() {
+    EEPROM.update(kEepromCebMarker, kCebMarker);
+    EEPROM.update(kEepromCebRinse, cebRinsePending ? 1 : 0);
+    EEPROM.update(kEepromCebCycles, serviceCyclesSinceCeb);
+}
+
 const char* labelForState(Fsm::State state) {
     return stateCodes[static_cast<uint8_t>(state)];
 }
@@ -96,6 +157,7 @@ void transitionTo(Fsm::State state) {
                 relaysPtr->permOn();
                 relaysPtr->washAOff();
                 relaysPtr->washBOff();
+                relaysPtr->dosingOff();
             }
             settleStartMs = stateStartMs;
             flushAActive = false;
@@ -116,12 +178,51 @@ void transitionTo(Fsm::State state) {
             }
             break;
         }
+        case Fsm::State::CEB:
+            // Close permeate and both wash valves, let them settle, then dose.
+            stateDurationMs = kSettleMs;
+            cebStep = CebStep::SETTLE;
+            cebRinsePending = true;
+            saveCebState();
+            if (relaysPtr) {
+                relaysPtr->permOn();
+                relaysPtr->washAOff();
+                relaysPtr->washBOff();
+                relaysPtr->dosingOff();
+            }
+            break;
     }
 
     uiSetState(labelForState(state));
     logStateChange(state);
 }
 
+void advanceCeb(uint32_t now) {
+    stateStartMs = now;
+    switch (cebStep) {
+        case CebStep::SETTLE:
+            cebStep = CebStep::DOSE;
+            stateDurationMs = settings.cebDoseSeconds * kMillisPerSecond;
+            if (relaysPtr) {
+                relaysPtr->dosingOn();
+            }
+            Serial.println(F("[FSM] CEB dose"));
+            break;
+        case CebStep::DOSE:
+            cebStep = CebStep::SOAK;
+            stateDurationMs = settings.cebSoakMinutes * kMillisPerMinute;
+            if (relaysPtr) {
+                relaysPtr->dosingOff();
+            }
+            Serial.println(F("[FSM] CEB soak"));
+            break;
+        case CebStep::SOAK:
+            // Rinse the chemical out with the regular flush sequence.
+            transitionTo(Fsm::State::FLUSH_A);
+            break;
+    }
+}
+
 void finishStartupCycle() {
     startupMode = false;
     startupFlushDone = true;
@@ -141,6 +242,8 @@ void begin(Relays* relays) {
     startupMode = false;
     startupFlushDone = false;
     startupRemainingMs = 0;
+    serviceCyclesSinceCeb = 0;
+    cebRinsePending = false;
     settings.serviceMinutes = static_cast<uint16_t>(clampServiceMinutes(60));
     settings.flushSeconds = static_cast<uint16_t>(clampFlushSeconds(60));
     uiSetTimers(settings.serviceMinutes, settings.flushSeconds);
@@ -153,7 +256,20 @@ void update() {
     switch (currentState) {
         case State::SERVICE: {
             if (running && stateDurationMs > 0 && (now - stateStartMs) >= stateDurationMs) {
-                transitionTo(State::FLUSH_A);
+                ++serviceCyclesSinceCeb;
+                if (settings.cebEveryCycles > 0 && serviceCyclesSinceCeb >= settings.cebEveryCycles) {
+                    serviceCyclesSinceCeb = 0;
+                    transitionTo(State::CEB);
+                } else {
+                    saveCebState();
+                    transitionTo(State::FLUSH_A);
+                }
+            }
+            break;
+        }
+        case State::CEB: {
+            if ((now - stateStartMs) >= stateDurationMs) {
+                advanceCeb(now);
             }
             break;
         }
@@ -215,6 +331,10 @@ void update() {
                         }
                         finishStartupCycle();
                     }
+                    if (cebRinsePending) {
+                        cebRinsePending = false;
+                        saveCebState();
+                    }
                     if (running) {
                         transitionTo(State::SERVICE);
                     } else {
@@ -238,7 +358,10 @@ void start() {
     running = true;
     Serial.println(F("[FSM] START"));
     if ((currentState == State::INIT || currentState == State::PAUSE)) {
-        if (startupFlushEnabled && !startupFlushDone) {
+        if (cebRinsePending) {
+            // An interrupted CEB left chemical in the modules: rinse first.
+            transitionTo(State::FLUSH_A);
+        } else if (startupFlushEnabled && !startupFlushDone) {
             startupMode = true;
             startupRemainingMs = kStartupFlushTotalMs;
             transitionTo(State::FLUSH_A);
@@ -270,7 +393,8 @@ void next() {
     switch (currentState) {
         case State::INIT:
         case State::PAUSE:
-            transitionTo(State::SERVICE);
+            // Same rule as start(): never return to service with chemical inside.
+            transitionTo(cebRinsePending ? State::FLUSH_A : State::SERVICE);
             running = true;
             break;
         case State::SERVICE:
@@ -295,6 +419,9 @@ void next() {
             settleStartMs = (now > kSettleMs) ? now - kSettleMs : now;
             update();
             break;
+        case State::CEB:
+            advanceCeb(now);
+            break;
     }
 }
 
@@ -338,6 +465,68 @@ uint16_t flushSeconds() {
     return settings.flushSeconds;
 }
 
+void setCebInterval(uint8_t cycles) {
+    uint8_t clamped = clampCebInterval(cycles);
+    if (settings.cebEveryCycles == clamped) {
+        return;
+    }
+    settings.cebEveryCycles = clamped;
+    Serial.print(F("[FSM] CEB_CICLOS="));
+    Serial.println(settings.cebEveryCycles);
+}
+
+void setCebDoseSeconds(uint16_t seconds) {
+    uint16_t clamped = clampCebDoseSeconds(seconds);
+    if (settings.cebDoseSeconds == clamped) {
+        return;
+    }
+    settings.cebDoseSeconds = clamped;
+    Serial.print(F("[FSM] T_DOSIS="));
+    Serial.print(settings.cebDoseSeconds);
+    Serial.println(F("s"));
+    if (currentState == State::CEB && cebStep == CebStep::DOSE) {
+        stateDurationMs = settings.cebDoseSeconds * kMillisPerSecond;
+    }
+}
+
+void setCebSoakMinutes(uint16_t minutes) {
+    uint16_t clamped = clampCebSoakMinutes(minutes);
+    if (settings.cebSoakMinutes == clamped) {
+        return;
+    }
+    settings.cebSoakMinutes = clamped;
+    Serial.print(F("[FSM] T_REMOJO="));
+    Serial.print(settings.cebSoakMinutes);
+    Serial.println(F("m"));
+    if (currentState == State::CEB && cebStep == CebStep::SOAK) {
+        stateDurationMs = settings.cebSoakMinutes * kMillisPerMinute;
+    }
+}
+
+bool cebRinseRequired() {
+    return cebRinsePending;
+}
+
+void restoreCeb() {
+    if (EEPROM.read(kEepromCebMarker) != kCebMarker) {
+        return;
+    }
+    cebRinsePending = EEPROM.read(kEepromCebRinse) != 0;
+    serviceCyclesSinceCeb = EEPROM.read(kEepromCebCycles);
+}
+
+uint8_t cebInterval() {
+    return settings.cebEveryCycles;
+}
+
+uint16_t cebDoseSeconds() {
+    return settings.cebDoseSeconds;
+}
+
+uint16_t cebSoakMinutes() {
+    return settings.cebSoakMinutes;
+}
+
 void getRemaining(uint16_t& minutes, uint16_t& seconds) {
     uint32_t now = millis();
     uint32_t remainingMs = 0;
@@ -352,7 +541,8 @@ void getRemaining(uint16_t& minutes, uint16_t& seconds) {
                 break;
             }
             // fall through
-        case State::SERVICE: {
+        case State::SERVICE:
+        case State::CEB: {
             if (stateDurationMs > 0) {
                 uint32_t elapsed = now - stateStartMs;
                 if (elapsed < stateDurationMs) {
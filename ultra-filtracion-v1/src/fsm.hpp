@@ -11,9 +11,12 @@ enum class State : uint8_t {
     SERVICE,
     FLUSH_A,
     FLUSH_B,
-    PAUSE
+    PAUSE,
+    CEB
 };
 
+constexpr uint8_t kStateCount = static_cast<uint8_t>(State::CEB) + 1;
+
 void begin(Relays* relays);
 void update();
 
@@ -28,6 +31,21 @@ void setFlushSeconds(uint16_t seconds);
 uint16_t serviceMinutes();
 uint16_t flushSeconds();
 
+// Chemically-enhanced backwash every `cycles` service cycles (0 disables).
+void setCebInterval(uint8_t cycles);
+void setCebDoseSeconds(uint16_t seconds);
+void setCebSoakMinutes(uint16_t minutes);
+
+uint8_t cebInterval();
+uint16_t cebDoseSeconds();
+uint16_t cebSoakMinutes();
+
+// True from CEB entry until its rinse finishes, so start()/next() rinse
+// before service even after a reset mid-CEB.
+bool cebRinseRequired();
+// Reloads the rinse flag and the cycle count from EEPROM. Call after begin().
+void restoreCeb();
+
 void getRemaining(uint16_t& minutes, uint16_t& seconds);
 State state();
 const char* stateLabel();
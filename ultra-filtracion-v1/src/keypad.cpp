@@ -1,32 +1,13 @@
 #include <Arduino.h>
 #include "keypad.hpp"
 
+#include "board.hpp"
+
 namespace {
-constexpr uint8_t kKeypadPin = A0;
 constexpr uint32_t kDebounceMs = 60;
 constexpr uint32_t kChordWindowMs = 750;
 constexpr int kHysteresis = 30;
 
-Keypad::Key mapAnalogToKey(int value, Keypad::Key lastStable) {
-    // Thresholds with hysteresis compensation
-    if (value < 50 + (lastStable == Keypad::Key::RIGHT ? kHysteresis : 0)) {
-        return Keypad::Key::RIGHT;
-    }
-    if (value < 150 + (lastStable == Keypad::Key::UP ? kHysteresis : 0)) {
-        return Keypad::Key::UP;
-    }
-    if (value < 350 + (lastStable == Keypad::Key::DOWN ? kHysteresis : 0)) {
-        return Keypad::Key::DOWN;
-    }
-    if (value < 550 + (lastStable == Keypad::Key::LEFT ? kHysteresis : 0)) {
-        return Keypad::Key::LEFT;
-    }
-    if (value < 800 + (lastStable == Keypad::Key::SELECT ? kHysteresis : 0)) {
-        return Keypad::Key::SELECT;
-    }
-    return Keypad::Key::NONE;
-}
-
 Keypad::Key lastRawKey = Keypad::Key::NONE;
 Keypad::Key stableKey = Keypad::Key::NONE;
 Keypad::Key lastReportedKey = Keypad::Key::NONE;
@@ -38,9 +19,29 @@ uint32_t lastChordMs = 0;
 
 namespace Keypad {
 
+Key mapAnalogToKey(int value, Key lastStable) {
+    // Thresholds with hysteresis compensation
+    if (value < Board::kKeyThresholds[0] + (lastStable == Key::RIGHT ? kHysteresis : 0)) {
+        return Key::RIGHT;
+    }
+    if (value < Board::kKeyThresholds[1] + (lastStable == Key::UP ? kHysteresis : 0)) {
+        return Key::UP;
+    }
+    if (value < Board::kKeyThresholds[2] + (lastStable == Key::DOWN ? kHysteresis : 0)) {
+        return Key::DOWN;
+    }
+    if (value < Board::kKeyThresholds[3] + (lastStable == Key::LEFT ? kHysteresis : 0)) {
+        return Key::LEFT;
+    }
+    if (value < Board::kKeyThresholds[4] + (lastStable == Key::SELECT ? kHysteresis : 0)) {
+        return Key::SELECT;
+    }
+    return Key::NONE;
+}
+
 Key readKey() {
     uint32_t now = millis();
-    int reading = analogRead(kKeypadPin);
+    int reading = analogRead(Board::kKeypadPin);
     Key raw = mapAnalogToKey(reading, stableKey);
 
     if (raw != lastRawKey) {
@@ -13,6 +13,7 @@ enum Key : uint8_t {
     SELECT
 };
 
+Key mapAnalogToKey(int value, Key lastStable);
 Key readKey();
 bool readChord();
 
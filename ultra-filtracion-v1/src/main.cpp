@@ -1,5 +1,7 @@
 #include <Arduino.h>
 
+#include "boot.hpp"
+#include "flow.hpp"
 #include "fsm.hpp"
 #include "keypad.hpp"
 #include "relays.hpp"
@@ -30,20 +32,21 @@ void adjustFlush(int16_t delta) {
 }
 
 void setup() {
+    // Control first; LCD and banner are finished by Boot::update() from loop().
+    Boot::begin(&relays);
+
     Serial.begin(115200);
+    Boot::mark(Boot::Stage::SERIAL_UP);
     Serial.println(F("[System] Booting"));
-
-    relays.begin();
-    uiBegin();
-
-    Fsm::begin(&relays);
-    Fsm::enableStartupFlush(false);
-    uiSetTimers(Fsm::serviceMinutes(), Fsm::flushSeconds());
-    uiSetState(Fsm::stateLabel());
-    Serial.println(F("[System] Ready"));
 }
 
 void loop() {
+    Boot::update();
+
+    // Fold pulses into the current phase before anything below can transition.
+    Flow::update();
+    uiSetFlow(Flow::totalMl(Flow::Meter::PERMEATE) / 1000UL, Flow::totalMl(Flow::Meter::FLUSH) / 1000UL);
+
     using namespace Keypad;
     Key key = readKey();
 
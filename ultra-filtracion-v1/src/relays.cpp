@@ -1,26 +1,126 @@
 #include "relays.hpp"
 
-#ifndef ACTIVE_LOW
-#define ACTIVE_LOW 1
+namespace {
+// The ACTIVE_LOW build flag still overrides the profile's relay polarity.
+#if defined(ACTIVE_LOW)
+constexpr bool kActiveLow = ACTIVE_LOW != 0;
+#else
+constexpr bool kActiveLow = Board::kRelayActiveLow;
 #endif
+}
+
+static_assert(Board::kRelayCount >= 4, "board profile needs the four core relays");
 
 namespace {
-constexpr bool kActiveLow = ACTIVE_LOW != 0;
+void writePin(uint8_t pin, bool on) {
+    digitalWrite(pin, on ? (kActiveLow ? LOW : HIGH) : (kActiveLow ? HIGH : LOW));
+}
+
+template <uint8_t N>
+struct RelayBank {
+    static constexpr uint8_t kPin = Board::kRelayPins[N - 1];
+
+    static void outputs() {
+        RelayBank<N - 1>::outputs();
+        pinMode(kPin, OUTPUT);
+    }
+
+    static void safe() {
+        RelayBank<N - 1>::safe();
+        writePin(kPin, false);
+    }
+
+    static void setAux(uint8_t index, bool on) {
+        RelayBank<N - 1>::setAux(index, on);
+        if (N > 4 && index == N - 5) {
+            writePin(kPin, on);
+        }
+    }
+};
+
+template <>
+struct RelayBank<0> {
+    static void outputs() {}
+    static void safe() {}
+    static void setAux(uint8_t, bool) {}
+};
+}  // namespace
+
+#if defined(__AVR__)
+namespace {
+// Bit mask of the relays wired to `port`, folded at compile time.
+constexpr uint8_t relayPortMask(char port, uint8_t n = Board::kRelayCount) {
+    return n == 0 ? 0
+                  : static_cast<uint8_t>(relayPortMask(port, n - 1) |
+                                         (Board::kRelayPorts[n - 1] == port ? (1U << Board::kRelayBits[n - 1]) : 0U));
+}
+}  // namespace
+
+// Latch the safe level before switching to output so no relay pulses on.
+#define RELAY_EARLY_SAFE_PORT(letter)                              \
+    do {                                                           \
+        constexpr uint8_t mask = relayPortMask(#letter[0]);        \
+        if (mask != 0) {                                           \
+            if (kActiveLow) {                                      \
+                PORT##letter |= mask;                              \
+            } else {                                               \
+                PORT##letter &= static_cast<uint8_t>(~mask);       \
+            }                                                      \
+            DDR##letter |= mask;                                   \
+        }                                                          \
+    } while (0)
+
+// Runs from .init3, right after the stack is set up and before .data/.bss,
+// static constructors, init() and setup(), so the relay outputs stop floating
+// within microseconds of a reset or brown-out. Only constant register writes
+// here: no calls into the core and nothing that needs a stack frame.
+void relaysEarlySafe() __attribute__((naked, used, section(".init3")));
+void relaysEarlySafe() {
+#if defined(PORTA)
+    RELAY_EARLY_SAFE_PORT(A);
+#endif
+#if defined(PORTB)
+    RELAY_EARLY_SAFE_PORT(B);
+#endif
+#if defined(PORTC)
+    RELAY_EARLY_SAFE_PORT(C);
+#endif
+#if defined(PORTD)
+    RELAY_EARLY_SAFE_PORT(D);
+#endif
+#if defined(PORTE)
+    RELAY_EARLY_SAFE_PORT(E);
+#endif
+#if defined(PORTF)
+    RELAY_EARLY_SAFE_PORT(F);
+#endif
+#if defined(PORTG)
+    RELAY_EARLY_SAFE_PORT(G);
+#endif
+#if defined(PORTH)
+    RELAY_EARLY_SAFE_PORT(H);
+#endif
+#if defined(PORTJ)
+    RELAY_EARLY_SAFE_PORT(J);
+#endif
+#if defined(PORTK)
+    RELAY_EARLY_SAFE_PORT(K);
+#endif
+#if defined(PORTL)
+    RELAY_EARLY_SAFE_PORT(L);
+#endif
 }
 
+#undef RELAY_EARLY_SAFE_PORT
+#endif
+
 void Relays::begin() {
-    pinMode(RelayPins::PERM, OUTPUT);
-    pinMode(RelayPins::WASH_A, OUTPUT);
-    pinMode(RelayPins::WASH_B, OUTPUT);
-    pinMode(RelayPins::FREE, OUTPUT);
     allSafe();
+    RelayBank<Board::kRelayCount>::outputs();
 }
 
 void Relays::allSafe() {
-    permOff();
-    washAOff();
-    washBOff();
-    write(RelayPins::FREE, false);
+    RelayBank<Board::kRelayCount>::safe();
 }
 
 void Relays::permOn() { write(RelayPins::PERM, true); }
@@ -32,6 +132,13 @@ void Relays::washAOff() { write(RelayPins::WASH_A, false); }
 void Relays::washBOn() { write(RelayPins::WASH_B, true); }
 void Relays::washBOff() { write(RelayPins::WASH_B, false); }
 
+void Relays::dosingOn() { write(RelayPins::FREE, true); }
+void Relays::dosingOff() { write(RelayPins::FREE, false); }
+
+void Relays::setAux(uint8_t index, bool on) {
+    RelayBank<Board::kRelayCount>::setAux(index, on);
+}
+
 void Relays::write(uint8_t pin, bool on) {
-    digitalWrite(pin, on ? (kActiveLow ? LOW : HIGH) : (kActiveLow ? HIGH : LOW));
+    writePin(pin, on);
 }
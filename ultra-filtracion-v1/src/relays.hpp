@@ -2,8 +2,12 @@
 
 #include <Arduino.h>
 
+#include "board.hpp"
+
 class Relays {
 public:
+    static constexpr uint8_t kAuxCount = Board::kRelayCount - 4;
+
     void begin();
     void allSafe();
 
@@ -16,13 +20,19 @@ public:
     void washBOn();
     void washBOff();
 
+    void dosingOn();
+    void dosingOff();
+
+    // Relays beyond the four core outputs (Mega2560 profiles only).
+    void setAux(uint8_t index, bool on);
+
 private:
     void write(uint8_t pin, bool on);
 };
 
 namespace RelayPins {
-    constexpr uint8_t PERM = 2;
-    constexpr uint8_t WASH_A = 3;
-    constexpr uint8_t WASH_B = 11;
-    constexpr uint8_t FREE = 12;
+    constexpr uint8_t PERM = Board::kRelayPins[0];
+    constexpr uint8_t WASH_A = Board::kRelayPins[1];
+    constexpr uint8_t WASH_B = Board::kRelayPins[2];
+    constexpr uint8_t FREE = Board::kRelayPins[3];  // CEB dosing pump
 }
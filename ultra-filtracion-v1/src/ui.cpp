@@ -4,20 +4,29 @@
 #include <stdio.h>
 #include <LiquidCrystal.h>
 
+#include "board.hpp"
+
 namespace {
-LiquidCrystal lcd(8, 9, 4, 5, 6, 7);
+// Constructed in uiBegin(): the LiquidCrystal constructor already runs the
+// controller's power-on delays, which must not delay reset-to-control.
+LiquidCrystal* lcd = nullptr;
 char currentState[6] = "INIT";
 uint16_t serviceMinutes = 60;
 uint16_t flushSeconds = 60;
+uint32_t permeateLiters = 0;
+uint32_t flushLiters = 0;
+constexpr uint32_t kLine2PageMs = 4000;
 }
 
 void uiBegin() {
-    lcd.begin(16, 2);
-    lcd.clear();
-    lcd.setCursor(0, 0);
-    lcd.print("INIT 00:00");
-    lcd.setCursor(0, 1);
-    lcd.print("TS= 60m TF= 60s");
+    static LiquidCrystal display(Board::kLcdRs, Board::kLcdEnable, Board::kLcdD4, Board::kLcdD5, Board::kLcdD6, Board::kLcdD7);
+    lcd = &display;
+    lcd->begin(16, 2);
+    lcd->clear();
+    lcd->setCursor(0, 0);
+    lcd->print("INIT 00:00");
+    lcd->setCursor(0, 1);
+    lcd->print("TS= 60m TF= 60s");
 }
 
 void uiSetState(const char* stateCode) {
@@ -30,23 +39,42 @@ void uiSetTimers(uint16_t tServiceMinutes, uint16_t tFlushSeconds) {
     flushSeconds = tFlushSeconds;
 }
 
+void uiSetFlow(uint32_t tPermeateLiters, uint32_t tFlushLiters) {
+    permeateLiters = tPermeateLiters;
+    flushLiters = tFlushLiters;
+}
+
+void uiFormat(char* line1, char* line2, uint16_t minutes, uint16_t seconds) {
+    snprintf(line1, kUiLineSize, "%-4s %02u:%02u", currentState, minutes, seconds);
+    // Second line alternates between the configured timers and the flow totals.
+    if ((millis() / kLine2PageMs) % 2 == 0) {
+        snprintf(line2, kUiLineSize, "TS=%3um TF=%3us", serviceMinutes, flushSeconds);
+    } else {
+        snprintf(line2, kUiLineSize, "P=%5luL F=%4luL",
+                 static_cast<unsigned long>(permeateLiters % 100000UL),
+                 static_cast<unsigned long>(flushLiters % 10000UL));
+    }
+}
+
 void uiRender(uint16_t minutes, uint16_t seconds) {
-    char line1[17];
-    char line2[17];
-    snprintf(line1, sizeof(line1), "%-4s %02u:%02u", currentState, minutes, seconds);
-    snprintf(line2, sizeof(line2), "TS=%3um TF=%3us", serviceMinutes, flushSeconds);
+    if (!lcd) {
+        return;
+    }
+    char line1[kUiLineSize];
+    char line2[kUiLineSize];
+    uiFormat(line1, line2, minutes, seconds);
 
-    lcd.setCursor(0, 0);
-    lcd.print(line1);
+    lcd->setCursor(0, 0);
+    lcd->print(line1);
     int len1 = strlen(line1);
     for (int i = len1; i < 16; ++i) {
-        lcd.print(' ');
+        lcd->print(' ');
     }
 
-    lcd.setCursor(0, 1);
-    lcd.print(line2);
+    lcd->setCursor(0, 1);
+    lcd->print(line2);
     int len2 = strlen(line2);
     for (int i = len2; i < 16; ++i) {
-        lcd.print(' ');
+        lcd->print(' ');
     }
 }
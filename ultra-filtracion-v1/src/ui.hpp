@@ -5,4 +5,10 @@
 void uiBegin();
 void uiSetState(const char* stateCode);
 void uiSetTimers(uint16_t tServiceMinutes, uint16_t tFlushSeconds);
+void uiSetFlow(uint32_t permeateLiters, uint32_t flushLiters);
 void uiRender(uint16_t minutes, uint16_t seconds);
+
+// Text of both LCD lines as uiRender() would show them, without touching the
+// display. Each buffer must hold kUiLineSize chars.
+constexpr uint8_t kUiLineSize = 17;
+void uiFormat(char* line1, char* line2, uint16_t minutes, uint16_t seconds);
@@ -0,0 +1,55 @@
+#include <Arduino.h>
+#include <LiquidCrystal.h>
+#include <unity.h>
+
+#include "boot.hpp"
+#include "relays.hpp"
+
+namespace {
+Relays relays;
+unsigned lcdBeginsAfterBootBegin = 0;
+bool doneAfterBootBegin = true;
+
+// Same sequence as setup()/loop() in main.cpp, run once at process start.
+void runBoot() {
+    Boot::begin(&relays);
+    lcdBeginsAfterBootBegin = LiquidCrystal::beginCalls;
+    doneAfterBootBegin = Boot::done();
+
+    Serial.begin(115200);
+    Boot::mark(Boot::Stage::SERIAL_UP);
+
+    for (uint8_t i = 0; i < 10 && !Boot::done(); ++i) {
+        Boot::update();
+    }
+}
+
+uint32_t at(Boot::Stage stage) {
+    return Boot::timestampUs(stage);
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_lcd_is_deferred_past_control() {
+    TEST_ASSERT_EQUAL_UINT32(0, lcdBeginsAfterBootBegin);
+    TEST_ASSERT_FALSE(doneAfterBootBegin);
+    TEST_ASSERT_TRUE(Boot::done());
+    TEST_ASSERT_EQUAL_UINT32(1, LiquidCrystal::beginCalls);
+}
+
+void test_stages_complete_in_order() {
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(at(Boot::Stage::CONTROL), at(Boot::Stage::SAFE));
+    TEST_ASSERT_LESS_THAN_UINT32(at(Boot::Stage::SERIAL_UP), at(Boot::Stage::CONTROL));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(at(Boot::Stage::LCD), at(Boot::Stage::SERIAL_UP));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(at(Boot::Stage::READY), at(Boot::Stage::LCD));
+}
+
+int main() {
+    runBoot();
+    UNITY_BEGIN();
+    RUN_TEST(test_lcd_is_deferred_past_control);
+    RUN_TEST(test_stages_complete_in_order);
+    return UNITY_END();
+}
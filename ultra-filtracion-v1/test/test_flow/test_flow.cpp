@@ -0,0 +1,118 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "flow.hpp"
+#include "fsm.hpp"
+#include "relays.hpp"
+
+namespace {
+Relays relays;
+constexpr uint32_t kPeriodUs = 20000UL;  // 50 Hz
+
+// Lets the burst's duration pass on the host clock, then injects it.
+void flowFor(Flow::Meter meter, uint16_t count) {
+    Host::advanceMicros(static_cast<unsigned long>(count) * kPeriodUs);
+    Flow::simulatePulses(meter, count, kPeriodUs);
+}
+}  // namespace
+
+void setUp() {
+    Host::setMicros(0);
+    Fsm::begin(&relays);
+    Fsm::stop();
+    Flow::begin();
+    Flow::reset();
+}
+
+void tearDown() {}
+
+void test_volume_is_attributed_to_current_phase() {
+    Fsm::start();
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::SERVICE), static_cast<int>(Fsm::state()));
+    flowFor(Flow::Meter::PERMEATE, 450);
+    Flow::update();
+    TEST_ASSERT_EQUAL_UINT32(1000, Flow::phaseMl(Flow::Meter::PERMEATE, Fsm::State::SERVICE));
+
+    Fsm::stop();
+    flowFor(Flow::Meter::PERMEATE, 225);
+    Flow::update();
+    TEST_ASSERT_EQUAL_UINT32(1000, Flow::phaseMl(Flow::Meter::PERMEATE, Fsm::State::SERVICE));
+    TEST_ASSERT_EQUAL_UINT32(500, Flow::phaseMl(Flow::Meter::PERMEATE, Fsm::State::PAUSE));
+    TEST_ASSERT_EQUAL_UINT32(1500, Flow::totalMl(Flow::Meter::PERMEATE));
+    TEST_ASSERT_EQUAL_UINT32(0, Flow::totalMl(Flow::Meter::FLUSH));
+}
+
+void test_fractional_millilitres_carry_over() {
+    for (uint16_t n = 0; n < 450; ++n) {
+        flowFor(Flow::Meter::FLUSH, 1);
+        Flow::update();
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, Flow::totalMl(Flow::Meter::FLUSH));
+}
+
+void test_counter_wrap_keeps_totals() {
+    Flow::simulateCounterAt(Flow::Meter::PERMEATE, UINT32_MAX - 100UL);
+    flowFor(Flow::Meter::PERMEATE, 450);
+    Flow::update();
+    TEST_ASSERT_EQUAL_UINT32(1000, Flow::totalMl(Flow::Meter::PERMEATE));
+}
+
+void test_rate_from_inter_pulse_period() {
+    // 50 pulses/s at 450 pulses/L is 6666 ml/min.
+    flowFor(Flow::Meter::PERMEATE, 10);
+    TEST_ASSERT_EQUAL_UINT32(6666, Flow::rateMlPerMin(Flow::Meter::PERMEATE));
+
+    // A second burst must continue from the previous pulse, not wrap the period.
+    flowFor(Flow::Meter::PERMEATE, 10);
+    TEST_ASSERT_EQUAL_UINT32(6666, Flow::rateMlPerMin(Flow::Meter::PERMEATE));
+
+    // 30 ms without a pulse: the rate drops to the 2000 pulses/min lower bound.
+    Host::advanceMicros(30000UL);
+    TEST_ASSERT_UINT32_WITHIN(5, 4444, Flow::rateMlPerMin(Flow::Meter::PERMEATE));
+
+    Host::advanceMicros(2000000UL);
+    TEST_ASSERT_EQUAL_UINT32(0, Flow::rateMlPerMin(Flow::Meter::PERMEATE));
+}
+
+void test_burst_that_does_not_fit_before_now_is_dropped() {
+    flowFor(Flow::Meter::FLUSH, 1);
+    // No time allowed for the burst: it would have to be stamped in the
+    // future, so the glitch filter drops it.
+    Flow::simulatePulses(Flow::Meter::FLUSH, 10, kPeriodUs);
+    Flow::update();
+    TEST_ASSERT_EQUAL_UINT32(2, Flow::totalMl(Flow::Meter::FLUSH));
+    TEST_ASSERT_EQUAL_UINT32(0, Flow::rateMlPerMin(Flow::Meter::FLUSH));
+}
+
+void test_rate_is_zero_without_pulses() {
+    TEST_ASSERT_EQUAL_UINT32(0, Flow::rateMlPerMin(Flow::Meter::FLUSH));
+}
+
+void test_restore_rejects_other_layout() {
+    flowFor(Flow::Meter::PERMEATE, 450);
+    Flow::update();
+    Flow::Totals saved;
+    Flow::snapshot(saved);
+
+    Flow::reset();
+    TEST_ASSERT_TRUE(Flow::restore(saved));
+    TEST_ASSERT_EQUAL_UINT32(1000, Flow::totalMl(Flow::Meter::PERMEATE));
+
+    Flow::Totals stale = saved;
+    stale.states = static_cast<uint8_t>(Fsm::kStateCount - 1);
+    stale.volumeMl[0][0] = 12345;
+    TEST_ASSERT_FALSE(Flow::restore(stale));
+    TEST_ASSERT_EQUAL_UINT32(1000, Flow::totalMl(Flow::Meter::PERMEATE));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_volume_is_attributed_to_current_phase);
+    RUN_TEST(test_fractional_millilitres_carry_over);
+    RUN_TEST(test_counter_wrap_keeps_totals);
+    RUN_TEST(test_rate_from_inter_pulse_period);
+    RUN_TEST(test_burst_that_does_not_fit_before_now_is_dropped);
+    RUN_TEST(test_rate_is_zero_without_pulses);
+    RUN_TEST(test_restore_rejects_other_layout);
+    return UNITY_END();
+}
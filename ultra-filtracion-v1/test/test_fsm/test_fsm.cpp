@@ -0,0 +1,115 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "boot.hpp"
+#include "fsm.hpp"
+#include "relays.hpp"
+
+namespace {
+Relays relays;
+
+void runUntil(Fsm::State state, unsigned long limitMs) {
+    for (unsigned long t = 0; t < limitMs && Fsm::state() != state; t += 100) {
+        Host::advanceMillis(100);
+        Fsm::update();
+    }
+}
+
+void runFor(unsigned long ms) {
+    for (unsigned long t = 0; t < ms; t += 100) {
+        Host::advanceMillis(100);
+        Fsm::update();
+    }
+}
+
+// RAM starts over, EEPROM keeps its contents; the FSM comes back paused.
+void simulateReset() {
+    Boot::begin(&relays);
+    Fsm::stop();
+}
+}  // namespace
+
+void setUp() {
+    Host::setMillis(1);
+    Host::eraseEeprom();
+    Fsm::begin(&relays);
+    Fsm::stop();
+    Fsm::setCebInterval(1);
+}
+
+void tearDown() {}
+
+void test_service_hands_over_to_ceb() {
+    Fsm::start();
+    runUntil(Fsm::State::CEB, 2UL * 3600UL * 1000UL);
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::CEB), static_cast<int>(Fsm::state()));
+    TEST_ASSERT_TRUE(Fsm::cebRinseRequired());
+}
+
+void test_next_after_interrupted_ceb_rinses_first() {
+    Fsm::start();
+    runUntil(Fsm::State::CEB, 2UL * 3600UL * 1000UL);
+    Fsm::stop();
+    Fsm::next();
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::FLUSH_A), static_cast<int>(Fsm::state()));
+}
+
+void test_start_after_interrupted_ceb_rinses_first() {
+    Fsm::start();
+    runUntil(Fsm::State::CEB, 2UL * 3600UL * 1000UL);
+    Fsm::stop();
+    Fsm::start();
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::FLUSH_A), static_cast<int>(Fsm::state()));
+}
+
+void test_completed_rinse_clears_pending_flag() {
+    Fsm::start();
+    runUntil(Fsm::State::CEB, 2UL * 3600UL * 1000UL);
+    runUntil(Fsm::State::SERVICE, 3600UL * 1000UL);
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::SERVICE), static_cast<int>(Fsm::state()));
+    TEST_ASSERT_FALSE(Fsm::cebRinseRequired());
+}
+
+void test_reset_mid_soak_rinses_before_service() {
+    Fsm::start();
+    runUntil(Fsm::State::CEB, 2UL * 3600UL * 1000UL);
+    // Past settle and the 30 s dose: soaking with chemical in the modules.
+    runFor(40UL * 1000UL);
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::CEB), static_cast<int>(Fsm::state()));
+
+    simulateReset();
+    TEST_ASSERT_TRUE(Fsm::cebRinseRequired());
+    Fsm::toggle();
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::FLUSH_A), static_cast<int>(Fsm::state()));
+
+    simulateReset();
+    Fsm::next();
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::FLUSH_A), static_cast<int>(Fsm::state()));
+
+    runUntil(Fsm::State::SERVICE, 3600UL * 1000UL);
+    simulateReset();
+    TEST_ASSERT_FALSE(Fsm::cebRinseRequired());
+}
+
+void test_cycle_count_survives_reset() {
+    Fsm::setCebInterval(2);
+    Fsm::start();
+    runUntil(Fsm::State::FLUSH_A, 2UL * 3600UL * 1000UL);
+
+    simulateReset();
+    Fsm::start();
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::SERVICE), static_cast<int>(Fsm::state()));
+    runUntil(Fsm::State::CEB, 2UL * 3600UL * 1000UL);
+    TEST_ASSERT_EQUAL(static_cast<int>(Fsm::State::CEB), static_cast<int>(Fsm::state()));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_service_hands_over_to_ceb);
+    RUN_TEST(test_next_after_interrupted_ceb_rinses_first);
+    RUN_TEST(test_start_after_interrupted_ceb_rinses_first);
+    RUN_TEST(test_completed_rinse_clears_pending_flag);
+    RUN_TEST(test_reset_mid_soak_rinses_before_service);
+    RUN_TEST(test_cycle_count_survives_reset);
+    return UNITY_END();
+}